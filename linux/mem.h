@@ -0,0 +1,4 @@
+/*
+* mem.h: memcpy and memset of the OS/2 compilers
+*/
+#include <string.h>
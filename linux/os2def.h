@@ -0,0 +1,30 @@
+/*************************************************************************
+*
+* File Name	 : OS2DEF.H
+*
+* Description: the OS/2 toolkit types used by the XDR library, for
+*			   building it on Linux and other systems without the
+*			   toolkit (see Makefile)
+*
+*************************************************************************/
+#ifndef _OS2DEF_INCLUDED
+#define _OS2DEF_INCLUDED
+
+#include <stddef.h>
+
+#define VOID	void
+#define TRUE	1
+#define FALSE	0
+
+typedef char			CHAR;
+typedef unsigned char	UCHAR;
+typedef unsigned char	BYTE;
+typedef short			SHORT;
+typedef unsigned short	USHORT;
+typedef int				INT;
+typedef unsigned int	UINT;
+typedef long			LONG;
+typedef unsigned long	ULONG;
+typedef unsigned long	BOOL;
+
+#endif /* _OS2DEF_INCLUDED */
@@ -0,0 +1,4 @@
+/*
+* xdr.h: the sources include the header in lower case
+*/
+#include "../XDR.H"
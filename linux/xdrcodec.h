@@ -0,0 +1,4 @@
+/*
+* xdrcodec.h: the sources include the header in lower case
+*/
+#include "../XDRCODEC.H"
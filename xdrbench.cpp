@@ -0,0 +1,700 @@
+/*************************************************************************
+*
+* File Name	 : XDRBENCH.CPP
+*
+* Description: performance measurements for XDR.CPP
+*
+* Exports	 : main()
+*
+* Imports	 : xdrmem_create <xdr.h>    xdr_int <xdr.h>
+*			   xdrstdio_create <xdr.h>	xdr_setstats <xdr.h>
+*			   xdr_getpos <xdr.h>		xdr_setpos <xdr.h>
+*			   xdr_hyper <xdr.h>		xdr_opaque <xdr.h>
+*			   xdr_union <xdr.h>		xdr_getop <xdr.h>
+*			   xdrseg_create <xdr.h>	xdrseg_reset <xdr.h>
+*			   xdr_string <xdr.h>		xdr_pointer <xdr.h>
+*			   xdr_setarena <xdr.h>		xdrarena_create <xdr.h>
+*			   xdrarena_reset <xdr.h>	xdrarena_destroy <xdr.h>
+*			   xdr_destroy <xdr.h>		xdr_array <xdr.h>
+*			   xdr_double <xdr.h>		xdr_u_hyper <xdr.h>
+*			   xdr::encode <xdrcodec.h>	xdr::decode <xdrcodec.h>
+*			   xdrpool_create <xdr.h>	xdrpool_destroy <xdr.h>
+*			   xdr_setpool <xdr.h>		xdr_array_par <xdr.h>
+*			   steady_clock <chrono>	sprintf <stdio.h>
+*			   printf <stdio.h>			tmpfile <stdio.h>
+*
+*      DISCLAIMER OF WARRANTIES.
+*      The code is provided "AS IS", without warranty of any kind.
+*
+*************************************************************************/
+#include <os2def.h>
+#include <xdr.h>
+#include <xdrcodec.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+/*
+* constants
+*/
+#define BENCH_BYTES		(4UL << 20)	// bytes converted per filter measurement
+#define MAX_ITEMS		65536		// largest message of bench_filters
+#define LIST_NODES		10000		// nodes of the decoded list
+#define ROUNDS			200			// decodes per measurement
+#define CODEC_ITEMS		100000		// structures per codec array
+#define CODEC_ROUNDS	50			// encodes/decodes per measurement
+#define LARGE_FIELDS	32			// opaque fields of a large message
+#define LARGE_FIELDSIZE	(1UL << 20)	// size of such a field
+#define LARGE_ROUNDS	20			// encodes per measurement
+#define PAR_ITEMS		2000000		// structures of a parallel array
+#define PAR_ROUNDS		5			// encodes/decodes per measurement
+#define SAMPLE_WIRE		24			// encoded size of a SAMPLE
+
+/*
+* linked list used to measure xdr_pointer and decode-time allocations
+*/
+typedef struct NODE	{
+	INT			id;
+	CHAR		*name;
+	struct NODE *next;
+	};
+
+static BOOL xdr_node(XDR *xdr, NODE *p)	{
+
+	return	xdr_int(xdr, &p->id) &&
+			xdr_string(xdr, &p->name, 64) &&
+			xdr_pointer(xdr, (CHAR **)&p->next, sizeof(NODE),
+												(xdrproc_t)xdr_node);
+	}
+
+static NODE		anode[LIST_NODES];
+static CHAR		aname[LIST_NODES][16];
+
+/*
+* discriminated union
+*/
+typedef struct VARIANT	{
+	INT			kind;
+	union	{
+		INT		i;
+		double	d;
+		CHAR	ch;
+		} u;
+	};
+
+static xdr_discrim variant_arms[] =	{
+	{ 1,	(xdrproc_t)xdr_int		},
+	{ 2,	(xdrproc_t)xdr_double	},
+	{ 3,	(xdrproc_t)xdr_char		},
+	{ 0,	(xdrproc_t)NULL			}	};
+
+/*
+* data of bench_filters
+*/
+static INT		aint[MAX_ITEMS], aintDec[MAX_ITEMS];
+static HYPER	ahyper[MAX_ITEMS];
+static double	adouble[MAX_ITEMS];
+static VARIANT	avar[MAX_ITEMS];
+static CHAR		abData[MAX_ITEMS+1], abDec[MAX_ITEMS+4];
+static XDR_ARENA *pListArena;
+
+/*
+* structure converted by a hand written filter and by xdrcodec.h
+*/
+typedef struct SAMPLE	{
+	INT			id;
+	SHORT		chan;
+	double		value;
+	UHYPER		stamp;
+	};
+
+static BOOL xdr_sample(XDR *xdr, SAMPLE *p)	{
+
+	return	xdr_int(xdr, &p->id) &&
+			xdr_short(xdr, &p->chan) &&
+			xdr_double(xdr, &p->value) &&
+			xdr_u_hyper(xdr, &p->stamp);
+	}
+
+template<> struct xdr::codec<SAMPLE> : xdr::record<SAMPLE,
+	XDR_FIELD(SAMPLE, id), XDR_FIELD(SAMPLE, chan),
+	XDR_FIELD(SAMPLE, value), XDR_FIELD(SAMPLE, stamp)>	{};
+
+/*
+* elapsed wall clock time in milliseconds (clock() would add up the
+* processor time of all threads)
+*/
+typedef std::chrono::steady_clock::time_point TIMER;
+
+static TIMER timer(VOID)	{
+
+	return std::chrono::steady_clock::now();
+	}
+
+static double msecs(TIMER start)	{
+
+	return std::chrono::duration<double, std::milli>(
+							std::chrono::steady_clock::now() - start).count();
+	}
+
+/*
+* link the first 'n' nodes of anode
+*/
+static VOID init_list(UINT n)	{
+	UINT i;
+
+	for(i = 0; i < n; i++)	{
+		sprintf(aname[i], "node %u", i);
+		anode[i].id		= i;
+		anode[i].name	= aname[i];
+		anode[i].next	= (i+1 < n)? &anode[i+1] : NULL;
+		}
+	}
+
+
+/*************************************************************************
+*
+* Names	: run_int, run_hyper, run_double, run_string, run_opaque,
+*		  run_array, run_union, run_list
+*
+* Descr.: encode/decode one message of 'n' elements (integers,
+*		  characters, union or list nodes) with one kind of filter
+*
+* Param.: XDR *xdr		- xdr handle
+*		  UINT n		- elements per message
+*
+* Return: BOOL fSuccess
+*
+*************************************************************************/
+static BOOL run_int(XDR *xdr, UINT n)	{
+	UINT i;
+
+	for(i = 0; i < n; i++)
+		if(!xdr_int(xdr, &aint[i]))
+			return FALSE;
+	return TRUE;
+	}
+
+static BOOL run_hyper(XDR *xdr, UINT n)	{
+	UINT i;
+
+	for(i = 0; i < n; i++)
+		if(!xdr_hyper(xdr, &ahyper[i]))
+			return FALSE;
+	return TRUE;
+	}
+
+static BOOL run_double(XDR *xdr, UINT n)	{
+	UINT i;
+
+	for(i = 0; i < n; i++)
+		if(!xdr_double(xdr, &adouble[i]))
+			return FALSE;
+	return TRUE;
+	}
+
+static BOOL run_string(XDR *xdr, UINT n)	{
+	CHAR ch	  = abData[n];
+	CHAR *psz = (xdr_getop(xdr) == XDR_ENCODE)? abData : abDec;
+	BOOL fOk;
+
+	abData[n] = 0;					// string of n characters
+	fOk = xdr_string(xdr, &psz, n);
+	abData[n] = ch;
+	return fOk;
+	}
+
+static BOOL run_opaque(XDR *xdr, UINT n)	{
+
+	return xdr_opaque(xdr, (xdr_getop(xdr) == XDR_ENCODE)? abData : abDec, n);
+	}
+
+static BOOL run_array(XDR *xdr, UINT n)	{
+	INT  *pa = (xdr_getop(xdr) == XDR_ENCODE)? aint : aintDec;
+	UINT c	 = n;
+
+	return xdr_array(xdr, (CHAR **)&pa, &c, n, sizeof(INT),
+												(xdrproc_t)xdr_int);
+	}
+
+static BOOL run_union(XDR *xdr, UINT n)	{
+	UINT i;
+
+	for(i = 0; i < n; i++)
+		if(!xdr_union(xdr, &avar[i].kind, (CHAR *)&avar[i].u,
+												variant_arms, NULL))
+			return FALSE;
+	return TRUE;
+	}
+
+static BOOL run_list(XDR *xdr, UINT n)	{
+	NODE *head;
+	BOOL fOk;
+
+	if(xdr_getop(xdr) == XDR_ENCODE)	{
+		anode[n-1].next = NULL;			// cut the list after n nodes
+		head = anode;
+		fOk  = xdr_pointer(xdr, (CHAR **)&head, sizeof(NODE),
+												(xdrproc_t)xdr_node);
+		anode[n-1].next = (n < LIST_NODES)? &anode[n] : NULL;
+		return fOk;
+		}
+
+	xdr_setarena(xdr, pListArena);		// decode into an arena
+	head = NULL;
+	fOk  = xdr_pointer(xdr, (CHAR **)&head, sizeof(NODE),
+												(xdrproc_t)xdr_node);
+	xdr_setarena(xdr, NULL);
+	xdrarena_reset(pListArena);
+	return fOk;
+	}
+
+/*
+* filters measured by bench_filters
+*/
+typedef struct BENCH	{
+	const CHAR	*pszName;
+	BOOL		(*pfnRun)(XDR *, UINT);
+	UINT		cMax;				// largest message (xdr_pointer recurses)
+	};
+
+static BENCH abench[] =	{
+	{ "int",	run_int,	MAX_ITEMS	},
+	{ "hyper",	run_hyper,	MAX_ITEMS	},
+	{ "double",	run_double,	MAX_ITEMS	},
+	{ "string",	run_string,	MAX_ITEMS	},
+	{ "opaque",	run_opaque,	MAX_ITEMS	},
+	{ "array",	run_array,	MAX_ITEMS	},
+	{ "union",	run_union,	MAX_ITEMS	},
+	{ "list",	run_list,	4096		}	};
+
+static UINT asize[] = { 16, 256, 4096, MAX_ITEMS };
+
+
+/*************************************************************************
+*
+* Name	: bench_stream
+*
+* Descr.: encode and decode messages of 'n' elements until about
+*		  BENCH_BYTES have been converted, print the throughput, the time
+*		  per element and the counters (see 'xdr_setstats') of a single
+*		  message
+*
+* Param.: BENCH *pb		- filter
+*		  UINT n		- elements per message
+*		  FILE *pf		- file of a standard I/O stream (NULL: memory)
+*
+*************************************************************************/
+static VOID bench_stream(BENCH *pb, UINT n, FILE *pf)	{
+	XDR			xdrE, xdrD;
+	XDR_STATS	statE, statD;
+	TIMER		start;
+	double		msE, msD;
+	UINT		cb, r, cRounds;
+
+	memset(&statE, 0, sizeof(XDR_STATS));
+	memset(&statD, 0, sizeof(XDR_STATS));
+
+	if(pf)	{
+		rewind(pf);
+		xdrstdio_create(&xdrE, pf, XDR_ENCODE);
+		}
+	else
+		xdrmem_create(&xdrE, NULL, 0, XDR_ENCODE);
+
+	xdr_setstats(&xdrE, &statE);		// first message is counted
+	if(!pb->pfnRun(&xdrE, n))	{
+		printf("%-7s encoding failed\n", pb->pszName);
+		xdr_destroy(&xdrE);
+		return;
+		}
+	xdr_setstats(&xdrE, NULL);
+
+	cb		= xdr_getpos(&xdrE);
+	cRounds	= (cb < BENCH_BYTES)? BENCH_BYTES / cb : 1;
+
+	start = timer();
+	for(r = 0; r < cRounds; r++)	{
+		xdr_setpos(&xdrE, 0);
+		pb->pfnRun(&xdrE, n);
+		}
+	msE = msecs(start);
+
+	if(pf)	{
+		fflush(pf);
+		rewind(pf);
+		xdrstdio_create(&xdrD, pf, XDR_DECODE);
+		}
+	else
+		xdrmem_create(&xdrD, xdrmem_base(&xdrE), cb, XDR_DECODE);
+
+	xdr_setstats(&xdrD, &statD);
+	if(!pb->pfnRun(&xdrD, n))	{
+		printf("%-7s decoding failed\n", pb->pszName);
+		xdr_destroy(&xdrD);
+		xdr_destroy(&xdrE);
+		return;
+		}
+	xdr_setstats(&xdrD, NULL);
+
+	start = timer();
+	for(r = 0; r < cRounds; r++)	{
+		xdr_setpos(&xdrD, 0);
+		pb->pfnRun(&xdrD, n);
+		}
+	msD = msecs(start);
+
+	if(msE <= 0)
+		msE = 0.001;
+	if(msD <= 0)
+		msD = 0.001;
+
+	printf("%-7s %-6s %6u %9.1f %8.2f %9.1f %8.2f %7llu %6llu %6llu %5llu %5llu\n",
+		pb->pszName, (pf)? "stdio" : "memory", n,
+		(double)cb * cRounds / (msE * 1000.0), msE * 1e6 / ((double)cRounds * n),
+		(double)cb * cRounds / (msD * 1000.0), msD * 1e6 / ((double)cRounds * n),
+		statE.cFilter, statE.cIO, statD.cIO, statE.cRealloc, statD.cAlloc);
+
+	xdr_destroy(&xdrD);
+	xdr_destroy(&xdrE);
+	}
+
+
+/*************************************************************************
+*
+* Name	: bench_filters
+*
+* Descr.: measure each kind of filter on memory and standard I/O streams
+*		  with messages of different sizes
+*
+*************************************************************************/
+static VOID bench_filters(VOID)	{
+	FILE *pf;
+	UINT b, s, i;
+
+	for(i = 0; i < MAX_ITEMS; i++)	{
+		aint[i]			= i * 7919;
+		ahyper[i]		= (HYPER)i << 33;
+		adouble[i]		= i * 0.25;
+		abData[i]		= (CHAR)('a' + i % 26);
+		avar[i].kind	= 1 + i % 3;
+		switch(avar[i].kind)	{
+			case 1:	avar[i].u.i  = i;				break;
+			case 2:	avar[i].u.d  = i * 0.5;			break;
+			case 3:	avar[i].u.ch = (CHAR)('A' + i % 26);	break;
+			}
+		}
+	init_list(LIST_NODES);
+
+	if((pf = tmpfile()) == NULL)	{
+		printf("can't create temporary file\n");
+		return;
+		}
+	pListArena = xdrarena_create(0);
+
+	printf("filter  stream  items  enc MB/s  ns/item  dec MB/s  ns/item"
+		   "   calls  io(e)  io(d) reall alloc\n");
+	for(b = 0; b < sizeof(abench) / sizeof(abench[0]); b++)
+		for(s = 0; s < sizeof(asize) / sizeof(asize[0]); s++)	{
+			if(asize[s] > abench[b].cMax)
+				continue;
+			bench_stream(&abench[b], asize[s], NULL);
+			bench_stream(&abench[b], asize[s], pf);
+			}
+
+	xdrarena_destroy(pListArena);
+	fclose(pf);
+	}
+
+
+/*************************************************************************
+*
+* Name	: bench_alloc
+*
+* Descr.: decode a linked list of LIST_NODES strings and nodes ROUNDS
+*		  times, allocating with malloc (and freeing with XDR_FREE) or
+*		  from an arena (and resetting it)
+*
+*************************************************************************/
+static VOID bench_alloc(VOID)	{
+	CHAR		abFree[4];
+	XDR			xdrE, xdrD, xdrF;
+	NODE		*head;
+	XDR_ARENA	*pArena;
+	TIMER		start;
+	UINT		cb;
+	INT			r;
+
+	init_list(LIST_NODES);
+	xdrmem_create(&xdrE, NULL, 0, XDR_ENCODE);
+	head = anode;
+	xdr_pointer(&xdrE, (CHAR **)&head, sizeof(NODE), (xdrproc_t)xdr_node);
+	cb = xdr_getpos(&xdrE);
+
+	/*
+	* malloc/free
+	*/
+	xdrmem_create(&xdrF, abFree, sizeof(abFree), XDR_FREE);
+	start = timer();
+	for(r = 0; r < ROUNDS; r++)	{
+		xdrmem_create(&xdrD, xdrmem_base(&xdrE), cb, XDR_DECODE);
+		head = NULL;
+		xdr_pointer(&xdrD, (CHAR **)&head, sizeof(NODE), (xdrproc_t)xdr_node);
+		xdr_pointer(&xdrF, (CHAR **)&head, sizeof(NODE), (xdrproc_t)xdr_node);
+		xdr_destroy(&xdrD);
+		}
+	printf("decode list, malloc/XDR_FREE : %8.1f ms\n", msecs(start));
+
+	/*
+	* arena
+	*/
+	pArena = xdrarena_create(0);
+	start = timer();
+	for(r = 0; r < ROUNDS; r++)	{
+		xdrmem_create(&xdrD, xdrmem_base(&xdrE), cb, XDR_DECODE);
+		xdr_setarena(&xdrD, pArena);
+		head = NULL;
+		xdr_pointer(&xdrD, (CHAR **)&head, sizeof(NODE), (xdrproc_t)xdr_node);
+		xdrarena_reset(pArena);
+		xdr_destroy(&xdrD);
+		}
+	printf("decode list, arena/reset     : %8.1f ms\n", msecs(start));
+	xdrarena_destroy(pArena);
+
+	xdr_destroy(&xdrF);
+	xdr_destroy(&xdrE);
+	}
+
+
+/*************************************************************************
+*
+* Name	: bench_codec
+*
+* Descr.: encode and decode an array of CODEC_ITEMS structures
+*		  CODEC_ROUNDS times, with xdr_array and a filter or with the
+*		  templates of xdrcodec.h
+*
+*************************************************************************/
+static VOID bench_codec(VOID)	{
+	static SAMPLE		asmp[CODEC_ITEMS];
+	std::vector<SAMPLE>	vsmp, vout;
+	XDR					xdrE, xdrD;
+	SAMPLE				*psmp;
+	TIMER				start;
+	UINT				c, cb;
+	INT					i, r;
+
+	for(i = 0; i < CODEC_ITEMS; i++)	{
+		asmp[i].id		= i;
+		asmp[i].chan	= (SHORT)(i % 16);
+		asmp[i].value	= i * 0.5;
+		asmp[i].stamp	= (UHYPER)i << 32;
+		}
+	vsmp.assign(asmp, asmp + CODEC_ITEMS);
+
+	/*
+	* xdrproc_t
+	*/
+	xdrmem_create(&xdrE, NULL, 0, XDR_ENCODE);
+	start = timer();
+	for(r = 0; r < CODEC_ROUNDS; r++)	{
+		xdr_setpos(&xdrE, 0);
+		psmp = asmp;
+		c	 = CODEC_ITEMS;
+		xdr_array(&xdrE, (CHAR **)&psmp, &c, CODEC_ITEMS, sizeof(SAMPLE),
+													(xdrproc_t)xdr_sample);
+		}
+	printf("encode array, filter  : %8.1f ms\n", msecs(start));
+	cb = xdr_getpos(&xdrE);
+
+	psmp = NULL;
+	start = timer();
+	for(r = 0; r < CODEC_ROUNDS; r++)	{
+		xdrmem_create(&xdrD, xdrmem_base(&xdrE), cb, XDR_DECODE);
+		xdr_array(&xdrD, (CHAR **)&psmp, &c, CODEC_ITEMS, sizeof(SAMPLE),
+													(xdrproc_t)xdr_sample);
+		xdr_destroy(&xdrD);
+		}
+	printf("decode array, filter  : %8.1f ms\n", msecs(start));
+	free(psmp);
+
+	/*
+	* xdrcodec.h
+	*/
+	start = timer();
+	for(r = 0; r < CODEC_ROUNDS; r++)	{
+		xdr_setpos(&xdrE, 0);
+		xdr::encode(&xdrE, vsmp);
+		}
+	printf("encode array, codec   : %8.1f ms\n", msecs(start));
+	if(xdr_getpos(&xdrE) != cb)
+		printf("codec size differs!\n");
+
+	start = timer();
+	for(r = 0; r < CODEC_ROUNDS; r++)	{
+		xdrmem_create(&xdrD, xdrmem_base(&xdrE), cb, XDR_DECODE);
+		xdr::decode(&xdrD, vout);
+		xdr_destroy(&xdrD);
+		}
+	printf("decode array, codec   : %8.1f ms\n", msecs(start));
+
+	xdr_destroy(&xdrE);
+	}
+
+
+/*************************************************************************
+*
+* Name	: bench_large
+*
+* Descr.: encode a message of LARGE_FIELDS opaque fields of
+*		  LARGE_FIELDSIZE bytes LARGE_ROUNDS times into a growing memory
+*		  stream and into a segment stream, copying the fields or
+*		  referring to them
+*
+*************************************************************************/
+static VOID large_msg(XDR *xdr, CHAR *pb)	{
+	UINT i, j;
+
+	for(i = 0; i < LARGE_FIELDS; i++)	{
+		j = i;
+		xdr_u_int(xdr, &j);
+		xdr_opaque(xdr, pb, LARGE_FIELDSIZE);
+		}
+	}
+
+static VOID bench_large(VOID)	{
+	static const CHAR *apszName[] =	{
+		"memory stream           ",
+		"segments, copied        ",
+		"segments, by reference  "	};
+	XDR_STATS	stat;
+	XDR			xdr;
+	TIMER		start;
+	CHAR		*pb;
+	INT			k, r;
+
+	if((pb = (CHAR *)malloc(LARGE_FIELDSIZE)) == NULL)
+		return;
+	memset(pb, 0x5A, LARGE_FIELDSIZE);
+
+	for(k = 0; k < 3; k++)	{
+		memset(&stat, 0, sizeof(XDR_STATS));
+		if(k)
+			xdrseg_create(&xdr, 0, (k == 2)? 4096 : 0);
+
+		start = timer();
+		for(r = 0; r < LARGE_ROUNDS; r++)	{
+			if(k)
+				xdrseg_reset(&xdr);
+			else
+				xdrmem_create(&xdr, NULL, 0, XDR_ENCODE);
+			xdr_setstats(&xdr, &stat);
+			large_msg(&xdr, pb);
+			if(!k)
+				xdr_destroy(&xdr);
+			}
+		printf("encode large message, %s: %8.1f ms, %llu reallocs\n",
+							apszName[k], msecs(start), stat.cRealloc);
+		if(k)
+			xdr_destroy(&xdr);
+		}
+	free(pb);
+	}
+
+
+/*************************************************************************
+*
+* Name	: bench_parallel
+*
+* Descr.: encode and decode an array of PAR_ITEMS structures PAR_ROUNDS
+*		  times with xdr_array_par, serially and on a pool of one
+*		  thread per processor. Encoding is measured with the encoded
+*		  size given and with a sizing pass.
+*
+*************************************************************************/
+static VOID bench_parallel(VOID)	{
+	static const CHAR *apszName[] =	{
+		"serial",
+		"pool  "	};
+	XDR_POOL	*pPool;
+	XDR			xdrE, xdrD;
+	SAMPLE		*asmp, *psmp;
+	TIMER		start;
+	UINT		c, cb;
+	INT			i, k, r;
+
+	if((asmp = (SAMPLE *)calloc(PAR_ITEMS, sizeof(SAMPLE))) == NULL)
+		return;
+	for(i = 0; i < PAR_ITEMS; i++)	{
+		asmp[i].id		= i;
+		asmp[i].chan	= (SHORT)(i % 16);
+		asmp[i].value	= i * 0.5;
+		asmp[i].stamp	= (UHYPER)i << 32;
+		}
+	pPool = xdrpool_create(0);
+
+	xdrmem_create(&xdrE, NULL, 0, XDR_ENCODE);
+	for(k = 0; k < 2; k++)	{
+		xdr_setpool(&xdrE, (k)? pPool : NULL);
+
+		start = timer();
+		for(r = 0; r < PAR_ROUNDS; r++)	{
+			xdr_setpos(&xdrE, 0);
+			psmp = asmp;
+			c	 = PAR_ITEMS;
+			xdr_array_par(&xdrE, (CHAR **)&psmp, &c, PAR_ITEMS,
+						sizeof(SAMPLE), SAMPLE_WIRE, (xdrproc_t)xdr_sample);
+			}
+		printf("encode array, %s, fixed size : %8.1f ms\n", apszName[k],
+																msecs(start));
+
+		start = timer();
+		for(r = 0; r < PAR_ROUNDS; r++)	{
+			xdr_setpos(&xdrE, 0);
+			psmp = asmp;
+			c	 = PAR_ITEMS;
+			xdr_array_par(&xdrE, (CHAR **)&psmp, &c, PAR_ITEMS,
+						sizeof(SAMPLE), 0, (xdrproc_t)xdr_sample);
+			}
+		printf("encode array, %s, sized      : %8.1f ms\n", apszName[k],
+																msecs(start));
+		cb = xdr_getpos(&xdrE);
+
+		psmp = NULL;
+		start = timer();
+		for(r = 0; r < PAR_ROUNDS; r++)	{
+			xdrmem_create(&xdrD, xdrmem_base(&xdrE), cb, XDR_DECODE);
+			xdr_setpool(&xdrD, (k)? pPool : NULL);
+			xdr_array_par(&xdrD, (CHAR **)&psmp, &c, PAR_ITEMS,
+						sizeof(SAMPLE), SAMPLE_WIRE, (xdrproc_t)xdr_sample);
+			xdr_destroy(&xdrD);
+			}
+		printf("decode array, %s, fixed size : %8.1f ms\n", apszName[k],
+																msecs(start));
+		if(memcmp(psmp, asmp, PAR_ITEMS * sizeof(SAMPLE)))
+			printf("decoded array differs!\n");
+		free(psmp);
+		}
+
+	xdr_destroy(&xdrE);
+	xdrpool_destroy(pPool);
+	free(asmp);
+	}
+
+/************************************************************************/
+
+int main(void)	{
+
+	bench_filters();
+	printf("%d nodes, %d rounds\n", LIST_NODES, ROUNDS);
+	bench_alloc();
+	printf("%d structures, %d rounds\n", CODEC_ITEMS, CODEC_ROUNDS);
+	bench_codec();
+	printf("%d fields of %lu bytes, %d rounds\n",
+					LARGE_FIELDS, LARGE_FIELDSIZE, LARGE_ROUNDS);
+	bench_large();
+	printf("%d structures, %d rounds\n", PAR_ITEMS, PAR_ROUNDS);
+	bench_parallel();
+	return 0;
+	}
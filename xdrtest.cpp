@@ -11,7 +11,31 @@
 *			   xdr_union <xdr.h>		xdr_destroy <xdr.h>
 *              strcpy <string.h>		printf <stdio.h>
 *              xdrstdio_create <xdr.h>  fopen <stdio.h>
-*			   fclose <stdio.h>
+*			   fclose <stdio.h>			xdrfeed_create <xdr.h>
+*			   xdrfeed_put <xdr.h>		xdrfeed_decode <xdr.h>
+*			   xdr_pointer <xdr.h>		xdr_array <xdr.h>
+*			   rand <stdlib.h>			xdrrec_create <xdr.h>
+*			   xdrrec_endofrecord <xdr.h>	xdrrec_skiprecord <xdr.h>
+*			   xdrrec_eof <xdr.h>		socketpair <sys/socket.h>
+*			   xdr_opaque_ref <xdr.h>	xdr_bytes_ref <xdr.h>
+*			   xdr_string_ref <xdr.h>	xdr_setpos <xdr.h>
+*			   xdr_inline <xdr.h>		xdr::encode <xdrcodec.h>
+*			   xdr::decode <xdrcodec.h>	xdr_long <xdr.h>
+*			   xdr_u_long <xdr.h>		xdrpool_create <xdr.h>
+*			   xdrpool_destroy <xdr.h>	xdr_setpool <xdr.h>
+*			   xdr_vector_par <xdr.h>	xdr_array_par <xdr.h>
+*			   xdr_setarena <xdr.h>		xdrarena_create <xdr.h>
+*			   xdrarena_alloc <xdr.h>	xdrarena_reset <xdr.h>
+*			   xdrarena_destroy <xdr.h>	xdr_short <xdr.h>
+*			   xdr_u_short <xdr.h>		xdr_hyper <xdr.h>
+*			   xdr_u_hyper <xdr.h>		xdr_float <xdr.h>
+*			   xdr_double <xdr.h>		tmpfile <stdio.h>
+*			   xdrbuf_create <xdr.h>	xdrbuf_flush <xdr.h>
+*			   xdrmmap_create <xdr.h>	xdrseg_create <xdr.h>
+*			   xdrseg_iov <xdr.h>		xdrseg_writev <xdr.h>
+*			   xdrseg_reset <xdr.h>		xdr_bytes <xdr.h>
+*			   xdr::size <xdrcodec.h>	xdr::fixed_size <xdrcodec.h>
+*			   xdr::proc <xdrcodec.h>	xdr_void <xdr.h>
 *
 * copyright (c) Jrg Caumanns, 1993 [caumanns@cs.tu-berlin.de]
 *
@@ -21,8 +45,23 @@
 *************************************************************************/
 #include <os2def.h>
 #include <xdr.h>
+#include <xdrcodec.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
+
+/*
+* rec_test sends records through a socket pair on POSIX systems and
+* through a buffer in memory elsewhere
+*/
+#if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+#define PIPE_SOCKET
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#endif
 
 /*
 * needed for xdr_union
@@ -34,9 +73,1196 @@ xdr_discrim filter_dir[] =	{
 	{ CHARACTER,(xdrproc_t)xdr_char		},
 	{ END,		(xdrproc_t)NULL		}	};
 
+/*
+* message decoded by feed_test: a string, an array and a list
+*/
+#define FEED_MSGS	100
+
+typedef struct ITEM	{
+	INT			value;
+	struct ITEM *next;
+	};
+
+typedef struct MSG	{
+	CHAR		*text;
+	INT			*pa;
+	UINT		c;
+	ITEM		*list;
+	};
+
+BOOL xdr_item(XDR *xdr, ITEM *p)	{
+
+	return	xdr_int(xdr, &p->value) &&
+			xdr_pointer(xdr, (CHAR **)&p->next, sizeof(ITEM),
+											(xdrproc_t)xdr_item);
+	}
+
+BOOL xdr_msg(XDR *xdr, MSG *p)	{
+
+	return	xdr_string(xdr, &p->text, 1024) &&
+			xdr_array(xdr, (CHAR **)&p->pa, &p->c, 1024, sizeof(INT),
+											(xdrproc_t)xdr_int) &&
+			xdr_pointer(xdr, (CHAR **)&p->list, sizeof(ITEM),
+											(xdrproc_t)xdr_item);
+	}
+
+/*
+* encode FEED_MSGS messages and decode them from pieces of random size;
+* a list of FEED_NODES nodes must decode on a 128 MB stack and fail (not
+* crash) on a 64 KB one, so must strings and byte arrays whose padded
+* length wraps around
+*/
+#define FEED_NODES	100000
+
+BOOL xdr_hugestr(XDR *xdr, CHAR **ppsz)	{
+
+	return xdr_string(xdr, ppsz, ~0U);
+	}
+
+BOOL feed_test(VOID)	{
+	static BYTE abHuge[12] = { 0xFF, 0xFF, 0xFF, 0xFD, 'a', 'b', 'c', 'd',
+							   0xFF, 0xFF, 0xFF, 0xFF };
+	XDR_ARENA *pArena;
+	XDR		xdrE, xdrF, xdrX;
+	BYTE	*pb;
+	CHAR	*psz;
+	MSG		msg;
+	ITEM	aitem[10], *pitem, *plist;
+	INT		aint[100];
+	CHAR	text[64];
+	UINT	cb, off, c, cPieces = 0;
+	INT		k, j;
+	BOOL	fOk = TRUE;
+
+	xdrfeed_create(&xdrF, 0);
+	if(!xdrfeed_put(&xdrF, text, 1))	{
+		printf("feed stream: not available\n");
+		xdr_destroy(&xdrF);
+		return TRUE;
+		}
+	xdr_destroy(&xdrF);
+
+	xdrmem_create(&xdrE, NULL, 0, XDR_ENCODE);
+	for(k = 0; k < FEED_MSGS; k++)	{
+		sprintf(text, "message %d", k);
+		for(j = 0; j < 10; j++)	{
+			aitem[j].value	= k * j;
+			aitem[j].next	= (j < k % 10)? &aitem[j+1] : NULL;
+			}
+		for(j = 0; j < 100; j++)
+			aint[j] = k + j;
+		msg.text	= text;
+		msg.pa		= aint;
+		msg.c		= k % 100;
+		msg.list	= aitem;
+		xdr_msg(&xdrE, &msg);
+		}
+	cb = xdr_getpos(&xdrE);
+
+	xdrfeed_create(&xdrF, 0);
+	xdrmem_create(&xdrX, text, sizeof(text), XDR_FREE);
+	memset(&msg, 0, sizeof(MSG));
+	for(k = 0, off = 0; (k < FEED_MSGS) && fOk; )	{
+		switch(xdrfeed_decode(&xdrF, (xdrproc_t)xdr_msg, &msg))	{
+			case XDR_OK:					// check and free message
+				sprintf(text, "message %d", k);
+				fOk = (strcmp(msg.text, text) == 0) && (msg.c == k % 100);
+				for(j = 0; fOk && (j < (INT)msg.c); j++)
+					fOk = (msg.pa[j] == k + j);
+				for(j = 0, pitem = msg.list; fOk && pitem; j++, pitem = pitem->next)
+					fOk = (pitem->value == k * j);
+				fOk = fOk && (j == k % 10 + 1);
+				xdr_msg(&xdrX, &msg);		// all pointers are NULL now
+				k++;
+				break;
+
+			case XDR_NEED_MORE:				// feed 1..16 bytes
+				c = 1 + rand() % 16;
+				if(c > cb - off)
+					c = cb - off;
+				fOk = (c > 0) && xdrfeed_put(&xdrF, xdrmem_base(&xdrE) + off, c);
+				off += c;
+				cPieces++;
+				break;
+
+			case XDR_ERROR:
+				fOk = FALSE;
+				break;
+			}
+		}
+	printf("feed stream: %d messages from %u pieces %s\n", k, cPieces,
+											(fOk)? "ok" : "FAILED");
+	xdr_destroy(&xdrF);
+
+	xdr_setpos(&xdrE, 0);				// what xdr_item encodes, flat
+	for(j = 0; j < FEED_NODES; j++)	{
+		c = (j + 1 < FEED_NODES);
+		fOk = fOk && xdr_int(&xdrE, &j) && xdr_u_int(&xdrE, &c);
+		}
+
+	for(k = 0; k < 2; k++)	{			// 128 MB stack, 64 KB stack
+		xdrfeed_create(&xdrF, (k)? 65536UL : 128UL << 20);
+		fOk = fOk && xdrfeed_put(&xdrF, xdrmem_base(&xdrE), xdr_getpos(&xdrE));
+		pitem = (ITEM *)calloc(1, sizeof(ITEM));
+		fOk = fOk && pitem && (xdrfeed_decode(&xdrF, (xdrproc_t)xdr_item,
+								pitem) == ((k)? XDR_ERROR : XDR_OK));
+		for(j = 0, plist = pitem; fOk && !k && plist; j++, plist = plist->next)
+			fOk = (plist->value == j);
+		fOk = fOk && (k || (j == FEED_NODES));
+		while((plist = pitem) != NULL)	{	// too deep for xdr_free
+			pitem = pitem->next;
+			free(plist);
+			}
+		xdr_destroy(&xdrF);
+		}
+	printf("feed stream: list of %d nodes %s\n", FEED_NODES,
+											(fOk)? "ok" : "FAILED");
+
+	xdrfeed_create(&xdrF, 0);
+	psz = NULL;
+	fOk = fOk && xdrfeed_put(&xdrF, (CHAR *)abHuge, 8) &&
+		  (xdrfeed_decode(&xdrF, (xdrproc_t)xdr_hugestr, &psz) == XDR_ERROR) &&
+		  !psz;
+	xdr_destroy(&xdrF);
+	if((pArena = xdrarena_create(0)) != NULL)	{	// 0 bytes are allocated
+		xdrmem_create(&xdrF, (CHAR *)abHuge, sizeof(abHuge), XDR_DECODE);
+		xdr_setarena(&xdrF, pArena);
+		psz = NULL;
+		pb	= NULL;
+		fOk = fOk && !xdr_string(&xdrF, &psz, ~0U) && xdr_setpos(&xdrF, 8) &&
+			  !xdr_bytes(&xdrF, &pb, &c, ~0U);
+		xdr_destroy(&xdrF);
+		xdrarena_destroy(pArena);
+		}
+	printf("feed stream: wrapping lengths %s\n", (fOk)? "ok" : "FAILED");
+
+	xdr_destroy(&xdrX);
+	xdr_destroy(&xdrE);
+	return fOk;
+	}
+
+/*
+* transport of rec_test
+*/
+typedef struct PIPE	{
+#ifdef PIPE_SOCKET
+	INT		afd[2];					// [0] read end, [1] write end
+#else
+	CHAR	ab[65536];				// bytes written, not yet read
+	INT		offRead;
+	INT		offWrite;
+#endif
+	};
+
+INT pipe_read(VOID *pv, CHAR *pb, INT cb)	{
+	PIPE *pp = (PIPE *)pv;
+
+#ifdef PIPE_SOCKET
+	return (INT)read(pp->afd[0], pb, cb);
+#else
+	if(cb > pp->offWrite - pp->offRead)
+		cb = pp->offWrite - pp->offRead;
+	memcpy(pb, pp->ab + pp->offRead, cb);
+	pp->offRead += cb;
+	return cb;
+#endif
+	}
+
+INT pipe_write(VOID *pv, CHAR *pb, INT cb)	{
+	PIPE *pp = (PIPE *)pv;
+
+#ifdef PIPE_SOCKET
+	return (INT)write(pp->afd[1], pb, cb);
+#else
+	if(cb > (INT)sizeof(pp->ab) - pp->offWrite)
+		return -1;
+	memcpy(pp->ab + pp->offWrite, pb, cb);
+	pp->offWrite += cb;
+	return cb;
+#endif
+	}
+
+BOOL pipe_open(PIPE *pp)	{
+
+#ifdef PIPE_SOCKET
+	return (socketpair(AF_UNIX, SOCK_STREAM, 0, pp->afd) == 0)? TRUE : FALSE;
+#else
+	pp->offRead = pp->offWrite = 0;
+	return TRUE;
+#endif
+	}
+
+VOID pipe_close(PIPE *pp, BOOL fAll)	{	// close write end (or both)
+
+#ifdef PIPE_SOCKET
+	if(pp->afd[1] >= 0)
+		close(pp->afd[1]);
+	pp->afd[1] = -1;
+	if(fAll)
+		close(pp->afd[0]);
+#endif
+	}
+
+/*
+* record stream: records of several fragments, decoded like Sun RPC
+* does (xdrrec_skiprecord before each record) and by skipping a record
+* read halfway; a fragment cut off by the end of input must fail
+*/
+BOOL rec_test(VOID)	{
+	static CHAR achCut[8] = { 0, 0, 0, 12, 0, 0, 0, 1 };
+	PIPE	pipe;
+	XDR		xdrE, xdrD;
+	INT		aint[100], aintD[100];
+	INT		k, j, id;
+	BOOL	fOk = TRUE;
+
+	if(!pipe_open(&pipe))
+		return FALSE;
+
+	xdrrec_create(&xdrE, 64, 0, &pipe, pipe_read, pipe_write, XDR_ENCODE);
+	for(k = 100; k < 104; k++)	{		// 4 records of 101 ints each
+		for(j = 0; j < 100; j++)
+			aint[j] = k * j;
+		fOk = fOk && xdr_int(&xdrE, &k) &&
+			xdr_vector(&xdrE, (CHAR *)aint, 100, sizeof(INT), (xdrproc_t)xdr_int) &&
+			xdrrec_endofrecord(&xdrE, (k == 101)? TRUE : FALSE);
+		}
+	k = 999;
+	fOk = fOk && xdr_int(&xdrE, &k) && xdrrec_endofrecord(&xdrE, TRUE);
+	xdr_destroy(&xdrE);
+										// fragment of 12 bytes, 4 sent
+	fOk = fOk && (pipe_write(&pipe, achCut, sizeof(achCut)) == 8);
+	pipe_close(&pipe, FALSE);
+
+	xdrrec_create(&xdrD, 0, 16, &pipe, pipe_read, pipe_write, XDR_DECODE);
+	for(k = 100; fOk && (k < 103); k++)	{	// Sun RPC style
+		fOk = xdrrec_skiprecord(&xdrD) && xdr_int(&xdrD, &id) && (id == k) &&
+			xdr_vector(&xdrD, (CHAR *)aintD, 100, sizeof(INT), (xdrproc_t)xdr_int);
+		for(j = 0; fOk && (j < 100); j++)
+			fOk = (aintD[j] == k * j);
+		}
+	fOk = fOk && !xdr_int(&xdrD, &id);	// end of record 102
+	fOk = fOk && xdrrec_skiprecord(&xdrD) && xdr_int(&xdrD, &id) && (id == 103);
+	fOk = fOk && xdrrec_skiprecord(&xdrD) && xdr_int(&xdrD, &id) && (id == 999);
+	fOk = fOk && xdrrec_skiprecord(&xdrD) && xdr_int(&xdrD, &id) && (id == 1);
+	fOk = fOk && !xdr_int(&xdrD, &id);	// fragment cut off
+	printf("record stream: %s\n", (fOk)? "ok" : "FAILED");
+
+	xdr_destroy(&xdrD);
+	pipe_close(&pipe, TRUE);
+	return fOk;
+	}
+
+/*
+* zero-copy decoding: data must point into the buffer; lengths running
+* past the end of the buffer (or wrapping around) must fail
+*/
+BOOL ref_test(VOID)	{
+	static BYTE abBad[16] = { 0, 0, 0, 0, 0xFF, 0xFF, 0xFF, 0xFC,
+							   0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0 };
+	XDR		xdrE, xdrD;
+	CHAR	*pb, *psz, *pbBase;
+	CHAR	ab[5] = { 1, 2, 3, 4, 5 };
+	UINT	cb, cbPadded, cch;
+	BOOL	fOk;
+
+	xdrmem_create(&xdrE, NULL, 0, XDR_ENCODE);
+	pb	= ab;
+	psz	= (CHAR *)"zero copy";
+	cb	= sizeof(ab);
+	cch	= strlen(psz);
+	fOk = xdr_bytes_ref(&xdrE, &pb, &cb, &cbPadded, 16) && (cbPadded == 8) &&
+		  xdr_string_ref(&xdrE, &psz, &cch, NULL, 16) &&
+		  xdr_opaque_ref(&xdrE, &pb, 3, NULL);
+
+	pbBase = xdrmem_base(&xdrE);
+	xdrmem_create(&xdrD, pbBase, xdr_getpos(&xdrE), XDR_DECODE);
+	fOk = fOk && xdr_bytes_ref(&xdrD, &pb, &cb, &cbPadded, 16) &&
+		  (pb == pbBase + 4) && (cb == 5) && (cbPadded == 8) &&
+		  !memcmp(pb, ab, 5) &&
+		  xdr_string_ref(&xdrD, &psz, &cch, NULL, 16) &&
+		  (cch == 9) && !memcmp(psz, "zero copy", 9) &&
+		  xdr_opaque_ref(&xdrD, &pb, 3, &cbPadded) && (cbPadded == 4) &&
+		  !memcmp(pb, ab, 3) && (xdr_getpos(&xdrD) == xdr_getpos(&xdrE)) &&
+		  !xdr_opaque_ref(&xdrD, &pb, 4, NULL);		// end of buffer
+	xdr_destroy(&xdrD);
+	xdr_destroy(&xdrE);
+
+	xdrmem_create(&xdrD, (CHAR *)abBad, sizeof(abBad), XDR_DECODE);
+	fOk = fOk && xdr_setpos(&xdrD, 4) &&
+		  !xdr_bytes_ref(&xdrD, &pb, &cb, NULL, ~0U) &&
+		  xdr_setpos(&xdrD, 4) &&
+		  !xdr_opaque_ref(&xdrD, &pb, 0xFFFFFFFC, NULL) &&
+		  xdr_setpos(&xdrD, 8) &&
+		  !xdr_string_ref(&xdrD, &psz, &cch, NULL, ~0U);
+	xdr_destroy(&xdrD);
+
+	printf("zero-copy decoding: %s\n", (fOk)? "ok" : "FAILED");
+	return fOk;
+	}
+
+/*
+* xdr_inline and std::string decoding must not be fooled by lengths that
+* wrap around; a string from a file grows with the bytes read only
+*/
+BOOL inline_test(VOID)	{
+	static BYTE abBad[16] = { 0, 0, 0, 0, 0xFF, 0xFF, 0xFF, 0xFD,
+							   0x7F, 0xFF, 0xFF, 0xF0, 0, 0, 0, 0 };
+	std::string	str;
+	XDR		xdrD, xdrE;
+	FILE	*pf;
+	BOOL	fOk;
+
+	xdrmem_create(&xdrD, (CHAR *)abBad, sizeof(abBad), XDR_DECODE);
+	fOk = xdr_setpos(&xdrD, 4) && !xdr_inline(&xdrD, 0xFFFFFFFC) &&
+		  (xdr_getpos(&xdrD) == 4) &&
+		  !xdr::decode(&xdrD, str) &&			// 0xFFFFFFFD bytes
+		  xdr_setpos(&xdrD, 8) && !xdr::decode(&xdrD, str);
+	xdr_destroy(&xdrD);
+
+	xdrmem_create(&xdrE, NULL, 0, XDR_ENCODE);
+	fOk = fOk && xdr_setpos(&xdrE, 8) && !xdr_inline(&xdrE, 0xFFFFFFFC);
+	xdr_destroy(&xdrE);
+
+	if((pf = tmpfile()) != NULL)	{		// no inline access: pieces
+		str.assign(100000, 'x');
+		str[99999] = 'y';
+		xdrstdio_create(&xdrE, pf, XDR_ENCODE);
+		fOk = fOk && xdr::encode(&xdrE, str) && xdr::encode(&xdrE, str) &&
+			  (fwrite(abBad + 8, 1, 4, pf) == 4);		// huge length
+		xdr_destroy(&xdrE);
+		rewind(pf);
+		xdrstdio_create(&xdrD, pf, XDR_DECODE);
+		str.clear();
+		fOk = fOk && xdr::decode(&xdrD, str) && (str.size() == 100000) &&
+			  (str[99999] == 'y') && xdr::decode(&xdrD, str) &&
+			  (str.size() == 100000) && !xdr::decode(&xdrD, str) &&
+			  (str.capacity() < 200000);
+		xdr_destroy(&xdrD);
+		fclose(pf);
+		}
+
+	printf("inline/string bounds: %s\n", (fOk)? "ok" : "FAILED");
+	return fOk;
+	}
+
+/*
+* LONG/ULONG are 32 bit on the wire, whatever their size in memory
+*/
+BOOL long_test(VOID)	{
+	XDR		xdrE, xdrD;
+	LONG	l = -5;
+	ULONG	ul = 0xFFFFFFFFUL;
+	BOOL	fOk;
+
+	xdrmem_create(&xdrE, NULL, 0, XDR_ENCODE);
+	fOk = xdr_long(&xdrE, &l) && xdr_u_long(&xdrE, &ul) &&
+		  (xdr_getpos(&xdrE) == 8);
+	if(sizeof(LONG) > 4)	{				// values that don't fit
+		l  = (LONG)((ULONG)1 << (8 * sizeof(LONG) - 2));
+		ul = (ULONG)l;
+		fOk = fOk && !xdr_long(&xdrE, &l) && !xdr_u_long(&xdrE, &ul);
+		}
+
+	xdrmem_create(&xdrD, xdrmem_base(&xdrE), 8, XDR_DECODE);
+	l  = (LONG)(~(ULONG)0 << 12);			// garbage in the upper bits
+	ul = ~(ULONG)0 << 12;
+	fOk = fOk && xdr_long(&xdrD, &l) && (l == -5) &&
+		  xdr_u_long(&xdrD, &ul) && (ul == 0xFFFFFFFFUL);
+	xdr_destroy(&xdrD);
+	xdr_destroy(&xdrE);
+
+	printf("long/u_long: %s\n", (fOk)? "ok" : "FAILED");
+	return fOk;
+	}
+
+/*
+* arena: messages decoded into small arena blocks equal the ones encoded;
+* a reset arena hands out its blocks again, truncated input and sizes
+* that wrap around fail
+*/
+BOOL arena_test(VOID)	{
+	XDR_ARENA *pArena;
+	XDR		xdrE, xdrD;
+	MSG		msg, msgD;
+	ITEM	aitem[10], *pitem;
+	INT		aint[100];
+	CHAR	*pFirst;
+	UINT	cb;
+	INT		k, j;
+	BOOL	fOk = TRUE;
+
+	if((pArena = xdrarena_create(256)) == NULL)
+		return FALSE;
+
+	for(j = 0; j < 10; j++)	{
+		aitem[j].value	= 7 * j;
+		aitem[j].next	= (j < 9)? &aitem[j+1] : NULL;
+		}
+	for(j = 0; j < 100; j++)
+		aint[j] = -j;
+	msg.text	= (CHAR *)"arena";
+	msg.pa		= aint;
+	msg.c		= 100;					// 400 bytes: a block of its own
+	msg.list	= aitem;
+
+	xdrmem_create(&xdrE, NULL, 0, XDR_ENCODE);
+	for(k = 0; k < 3; k++)
+		fOk = fOk && xdr_msg(&xdrE, &msg);
+	cb = xdr_getpos(&xdrE);
+
+	for(k = 0, pFirst = NULL; fOk && (k < 2); k++)	{	// reset in between
+		xdrmem_create(&xdrD, xdrmem_base(&xdrE), cb, XDR_DECODE);
+		xdr_setarena(&xdrD, pArena);
+		for(INT i = 0; fOk && (i < 3); i++)	{
+			memset(&msgD, 0, sizeof(MSG));
+			fOk = xdr_msg(&xdrD, &msgD) && !strcmp(msgD.text, "arena") &&
+				  (msgD.c == 100) && !memcmp(msgD.pa, aint, sizeof(aint));
+			for(j = 0, pitem = msgD.list; fOk && pitem; j++, pitem = pitem->next)
+				fOk = (pitem->value == 7 * j);
+			fOk = fOk && (j == 10);
+			if(!i)	{
+				fOk = fOk && (!pFirst || (pFirst == msgD.text));
+				pFirst = msgD.text;
+				}
+			}
+		xdr_destroy(&xdrD);
+		xdrarena_reset(pArena);
+		}
+
+	xdrmem_create(&xdrD, xdrmem_base(&xdrE), cb / 3 - 4, XDR_DECODE);
+	xdr_setarena(&xdrD, pArena);			// last item cut off
+	memset(&msgD, 0, sizeof(MSG));
+	fOk = fOk && !xdr_msg(&xdrD, &msgD);
+	xdr_setarena(&xdrD, NULL);				// malloc again
+	xdr_setpos(&xdrD, 0);
+	memset(&msgD, 0, sizeof(MSG));
+	fOk = fOk && xdr_string(&xdrD, &msgD.text, 16) &&
+		  !strcmp(msgD.text, "arena");
+	free(msgD.text);
+	xdr_destroy(&xdrD);
+	xdr_destroy(&xdrE);
+
+	fOk = fOk && !xdrarena_alloc(pArena, ~0UL) &&
+		  !xdrarena_alloc(pArena, ~0UL - 8) &&
+		  ((pFirst = (CHAR *)xdrarena_alloc(pArena, 1000)) != NULL);
+	if(pFirst)
+		memset(pFirst, 0, 1000);
+	xdrarena_destroy(pArena);
+
+	printf("arena: %s\n", (fOk)? "ok" : "FAILED");
+	return fOk;
+	}
+
+/*
+* primitive types converted in bulk by xdr_vector
+*/
+#define BULK_MAXOBJ	67				// 0..67: vector loops and their tails
+#define BULK_FILEOBJ 3000			// more than a chunk of a file stream
+
+typedef struct BULKTYPE	{
+	xdrproc_t	proc;
+	UINT		cbObj;
+	UINT		cbWire;
+	};
+
+static BULKTYPE abt[] =	{
+	{ (xdrproc_t)xdr_int,		sizeof(INT),	4 },
+	{ (xdrproc_t)xdr_u_int,		sizeof(UINT),	4 },
+	{ (xdrproc_t)xdr_float,		sizeof(float),	4 },
+	{ (xdrproc_t)xdr_short,		sizeof(SHORT),	4 },
+	{ (xdrproc_t)xdr_u_short,	sizeof(USHORT),	4 },
+	{ (xdrproc_t)xdr_hyper,		sizeof(HYPER),	8 },
+	{ (xdrproc_t)xdr_u_hyper,	sizeof(UHYPER),	8 },
+	{ (xdrproc_t)xdr_double,	sizeof(double),	8 }	};
+
+#define BULK_TYPES	(sizeof(abt) / sizeof(abt[0]))
+
+VOID bulk_fill(UINT t, CHAR *pa, UINT c)	{	// values of type abt[t]
+	INT		i;	UINT	u;	float	f;	SHORT	s;
+	USHORT	us;	HYPER	h;	UHYPER	uh;	double	d;
+
+	for(UINT k = 0; k < c; k++, pa += abt[t].cbObj)	{
+		switch(t)	{
+			case 0: i  = (INT)(k * 0x01030507) - 12345;	memcpy(pa, &i, 4);	break;
+			case 1: u  = k * 0x9E3779B9U;				memcpy(pa, &u, 4);	break;
+			case 2: f  = (float)k * -1.25f + 0.5f;		memcpy(pa, &f, 4);	break;
+			case 3: s  = (SHORT)(k * 1031 - 30000);		memcpy(pa, &s, 2);	break;
+			case 4: us = (USHORT)(k * 2053 + 1);		memcpy(pa, &us, 2);	break;
+			case 5: h  = ((HYPER)k << 35) - (HYPER)k * 77;	memcpy(pa, &h, 8);	break;
+			case 6: uh = (UHYPER)k * 0x9E3779B97F4A7C15ULL;	memcpy(pa, &uh, 8);	break;
+			case 7: d  = (double)k * 1.0e-3 - 7.5;		memcpy(pa, &d, 8);	break;
+			}
+		}
+	}
+
+/*
+* bulk conversions: arrays at any alignment and of any length encode like
+* element by element and decode to the same values; input one byte short
+* fails, on a memory stream and on a file; so does a count that makes
+* the array's size wrap around
+*/
+BOOL bulk_test(VOID)	{
+	static CHAR achSrc[BULK_MAXOBJ * 8 + 8], achDst[BULK_MAXOBJ * 8 + 8];
+	static CHAR achWire[BULK_MAXOBJ * 8 + 8];
+	XDR		xdrS, xdrE, xdrD;
+	CHAR	*pa, *pFile, *pFileD, tmp[8];
+	FILE	*pf;
+	UINT	t, c, off, k, cb;
+	BOOL	fOk = TRUE;
+
+	for(t = 0; fOk && (t < BULK_TYPES); t++)	{
+		for(c = 0; fOk && (c <= BULK_MAXOBJ); c++)	{
+			for(off = 0; fOk && (off < 8); off++)	{
+				pa = achSrc + off;
+				bulk_fill(t, pa, c);
+				cb = c * abt[t].cbWire;
+
+				xdrmem_create(&xdrS, NULL, 0, XDR_ENCODE);	// one by one
+				for(k = 0; fOk && (k < c); k++)	{
+					memcpy(tmp, pa + k * abt[t].cbObj, abt[t].cbObj);
+					fOk = abt[t].proc(&xdrS, tmp);
+					}
+				xdrmem_create(&xdrE, NULL, 0, XDR_ENCODE);	// in bulk
+				fOk = fOk && xdr_vector(&xdrE, pa, c, abt[t].cbObj, abt[t].proc) &&
+					  (xdr_getpos(&xdrE) == cb) && (xdr_getpos(&xdrS) == cb) &&
+					  !memcmp(xdrmem_base(&xdrE), xdrmem_base(&xdrS), cb);
+
+				if(fOk)	{			// unaligned wire and array
+					memcpy(achWire + 7 - off, xdrmem_base(&xdrE), cb);
+					xdrmem_create(&xdrD, achWire + 7 - off, cb, XDR_DECODE);
+					memset(achDst, 0x55, sizeof(achDst));
+					fOk = xdr_vector(&xdrD, achDst + off, c, abt[t].cbObj,
+															abt[t].proc) &&
+						  !memcmp(achDst + off, pa, c * abt[t].cbObj) &&
+						  (achDst[off + c * abt[t].cbObj] == 0x55);
+					xdr_destroy(&xdrD);
+					}
+				if(fOk && c)	{	// one byte short
+					xdrmem_create(&xdrD, achWire + 7 - off, cb - 1, XDR_DECODE);
+					fOk = !xdr_vector(&xdrD, achDst + off, c, abt[t].cbObj,
+															abt[t].proc);
+					xdr_destroy(&xdrD);
+					}
+				xdr_destroy(&xdrE);
+				xdr_destroy(&xdrS);
+				}
+			}
+		}
+
+	pFile  = (CHAR *)malloc(BULK_FILEOBJ * 8 + 1);
+	pFileD = (CHAR *)malloc(BULK_FILEOBJ * 8 + 1);
+	for(t = 0; fOk && pFile && pFileD && (t < BULK_TYPES); t++)	{
+		if((pf = tmpfile()) == NULL)
+			break;
+		bulk_fill(t, pFile + 1, BULK_FILEOBJ);
+		xdrstdio_create(&xdrE, pf, XDR_ENCODE);
+		fOk = xdr_vector(&xdrE, pFile + 1, BULK_FILEOBJ, abt[t].cbObj,
+															abt[t].proc);
+		xdr_destroy(&xdrE);
+		fflush(pf);
+		rewind(pf);
+		xdrstdio_create(&xdrD, pf, XDR_DECODE);
+		fOk = fOk && xdr_vector(&xdrD, pFileD + 1, BULK_FILEOBJ - 1,
+											abt[t].cbObj, abt[t].proc) &&
+			  !memcmp(pFileD + 1, pFile + 1, (BULK_FILEOBJ - 1) * abt[t].cbObj) &&
+			  !xdr_vector(&xdrD, pFileD + 1, 2, abt[t].cbObj, abt[t].proc);
+		xdr_destroy(&xdrD);
+		fclose(pf);
+		}
+
+	if(fOk && pFile && ((pf = tmpfile()) != NULL))	{	// count * size wraps
+		memset(pFile, 0, BULK_FILEOBJ * 8);
+		xdrstdio_create(&xdrE, pf, XDR_ENCODE);
+		c = 0x40000001;
+		fOk = xdr_u_int(&xdrE, &c) &&
+			  xdr_opaque(&xdrE, pFile, BULK_FILEOBJ * 8);
+		xdr_destroy(&xdrE);
+		fflush(pf);
+		rewind(pf);
+		xdrstdio_create(&xdrD, pf, XDR_DECODE);
+		pa = NULL;
+		fOk = fOk && !xdr_array(&xdrD, &pa, &c, ~0U, sizeof(INT),
+											(xdrproc_t)xdr_int) && !pa;
+		xdr_destroy(&xdrD);
+		fclose(pf);
+		}
+	free(pFileD);
+	free(pFile);
+
+	printf("bulk conversion: %s\n", (fOk)? "ok" : "FAILED");
+	return fOk;
+	}
+
+/*
+* message of file_test/seg_test: a large int array, a blob, a string and a list
+*/
+#define STREAM_INTS	1000
+#define STREAM_BLOB	300
+#define STREAM_MSGS	200					// fill a socket's buffer
+
+BOOL stream_msg(XDR *xdr, XDR_OP op, UINT cInts)	{
+	static BYTE abBlob[STREAM_BLOB];
+	INT		aint[STREAM_INTS], aintD[STREAM_INTS];
+	ITEM	aitem[5], *pitem;
+	MSG		msg;
+	XDR		xdrX;
+	BYTE	*pb = NULL;
+	UINT	cb = STREAM_BLOB, c, j;
+	BOOL	fOk;
+
+	for(j = 0; j < STREAM_BLOB; j++)
+		abBlob[j] = (BYTE)(j * 7);
+	for(j = 0; j < cInts; j++)
+		aint[j] = j * j;
+	for(j = 0; j < 5; j++)	{
+		aitem[j].value	= j + 1;
+		aitem[j].next	= (j < 4)? &aitem[j+1] : NULL;
+		}
+	msg.text	= (CHAR *)"stream";
+	msg.pa		= aint;
+	msg.c		= 3;
+	msg.list	= aitem;
+
+	if(op == XDR_ENCODE)	{
+		pb = abBlob;
+		return	xdr_vector(xdr, (CHAR *)aint, cInts, sizeof(INT),
+											(xdrproc_t)xdr_int) &&
+				xdr_bytes(xdr, &pb, &cb, STREAM_BLOB) && xdr_msg(xdr, &msg);
+		}
+
+	memset(&msg, 0, sizeof(MSG));
+	fOk = xdr_vector(xdr, (CHAR *)aintD, cInts, sizeof(INT),
+											(xdrproc_t)xdr_int) &&
+		  !memcmp(aintD, aint, cInts * sizeof(INT)) &&
+		  xdr_bytes(xdr, &pb, &c, STREAM_BLOB) && (c == STREAM_BLOB) &&
+		  !memcmp(pb, abBlob, STREAM_BLOB) &&
+		  xdr_msg(xdr, &msg) && !strcmp(msg.text, "stream") && (msg.c == 3) &&
+		  !memcmp(msg.pa, aint, 3 * sizeof(INT));
+	for(j = 0, pitem = msg.list; fOk && pitem; j++, pitem = pitem->next)
+		fOk = (pitem->value == (INT)j + 1);
+	fOk = fOk && (j == 5);
+
+	xdrmem_create(&xdrX, NULL, 0, XDR_FREE);
+	xdr_bytes(&xdrX, &pb, &c, STREAM_BLOB);
+	xdr_msg(&xdrX, &msg);
+	xdr_destroy(&xdrX);
+	return fOk;
+	}
+
+/*
+* copy the first 'cb' bytes of 'pb' to a new temporary file
+*/
+FILE *stream_file(CHAR *pb, UINT cb)	{
+	FILE *pf;
+
+	if((pf = tmpfile()) == NULL)
+		return NULL;
+	if((fwrite(pb, 1, cb, pf) != cb) || (fflush(pf) != 0))	{
+		fclose(pf);
+		return NULL;
+		}
+	rewind(pf);
+	return pf;
+	}
+
+/*
+* buffered and mapped streams: the bytes written equal those of a memory
+* stream and decode to the same message; input one byte short fails, so
+* does mapping an empty file or a socket
+*/
+BOOL file_test(VOID)	{
+#ifdef PIPE_SOCKET
+	PIPE	pipe;
+#endif
+	XDR		xdrM, xdrE, xdrD;
+	FILE	*pf, *pfShort;
+	CHAR	*pb;
+	UINT	cb, cb1, c;
+	BOOL	fOk;
+
+	xdrmem_create(&xdrM, NULL, 0, XDR_ENCODE);	// reference
+	fOk = stream_msg(&xdrM, XDR_ENCODE, STREAM_INTS);
+	cb1	= xdr_getpos(&xdrM);
+	fOk = fOk && stream_msg(&xdrM, XDR_ENCODE, 7);
+	cb	= xdr_getpos(&xdrM);
+	pb	= (CHAR *)malloc(cb + 1);
+
+	if(fOk && pb && ((pf = tmpfile()) != NULL))	{	// buffered
+		xdrbuf_create(&xdrE, pf, 64, XDR_ENCODE);
+		fOk = stream_msg(&xdrE, XDR_ENCODE, STREAM_INTS) &&
+			  xdrbuf_flush(&xdrE) && stream_msg(&xdrE, XDR_ENCODE, 7);
+		xdr_destroy(&xdrE);
+		rewind(pf);
+		fOk = fOk && (fread(pb, 1, cb + 1, pf) == cb) &&
+			  !memcmp(pb, xdrmem_base(&xdrM), cb);
+		rewind(pf);
+		xdrbuf_create(&xdrD, pf, 100, XDR_DECODE);
+		fOk = fOk && stream_msg(&xdrD, XDR_DECODE, STREAM_INTS) &&
+			  stream_msg(&xdrD, XDR_DECODE, 7) && !xdr_int(&xdrD, (INT *)&c);
+		xdr_destroy(&xdrD);
+		fclose(pf);
+		}
+	else
+		fOk = FALSE;
+
+	if(fOk && ((pfShort = stream_file(xdrmem_base(&xdrM), cb - 1)) != NULL)) {
+		xdrbuf_create(&xdrD, pfShort, 0, XDR_DECODE);
+		fOk = stream_msg(&xdrD, XDR_DECODE, STREAM_INTS) &&
+			  !stream_msg(&xdrD, XDR_DECODE, 7);
+		xdr_destroy(&xdrD);
+		fclose(pfShort);
+		}
+
+	if(fOk && ((pf = stream_file(xdrmem_base(&xdrM), cb)) != NULL))	{	// mapped
+		fOk = xdrmmap_create(&xdrD, pf) &&
+			  stream_msg(&xdrD, XDR_DECODE, STREAM_INTS) &&
+			  stream_msg(&xdrD, XDR_DECODE, 7) && (xdr_getpos(&xdrD) == cb) &&
+			  !xdr_int(&xdrD, (INT *)&c);
+		xdr_destroy(&xdrD);
+		fOk = fOk && (fseek(pf, cb1, SEEK_SET) == 0) &&	// from the file
+			  xdrmmap_create(&xdrD, pf) && stream_msg(&xdrD, XDR_DECODE, 7) &&
+			  (xdr_getpos(&xdrD) == cb);			// position on
+		xdr_destroy(&xdrD);
+		fclose(pf);
+		}
+	if(fOk && ((pfShort = stream_file(xdrmem_base(&xdrM), cb - 1)) != NULL)) {
+		fOk = xdrmmap_create(&xdrD, pfShort) &&
+			  stream_msg(&xdrD, XDR_DECODE, STREAM_INTS) &&
+			  !stream_msg(&xdrD, XDR_DECODE, 7);
+		xdr_destroy(&xdrD);
+		fclose(pfShort);
+		}
+	if(fOk && ((pf = tmpfile()) != NULL))	{	// nothing to map
+		fOk = !xdrmmap_create(&xdrD, pf) && (ftell(pf) == 0);
+		xdr_destroy(&xdrD);
+		fclose(pf);
+		}
+#ifdef PIPE_SOCKET
+	if(fOk && pipe_open(&pipe))	{
+		if((pf = fdopen(pipe.afd[0], "rb")) != NULL)	{
+			fOk = !xdrmmap_create(&xdrD, pf);
+			xdr_destroy(&xdrD);
+			fclose(pf);
+			pipe.afd[0] = -1;		// closed by fclose
+			}
+		pipe_close(&pipe, TRUE);
+		}
+#endif
+
+	printf("buffered/mapped streams: %s\n", (fOk)? "ok" : "FAILED");
+	free(pb);
+	xdr_destroy(&xdrM);
+	return fOk;
+	}
+
+/*
+* segment stream: the pieces hold the bytes of a memory stream, also after
+* a reset; a non-blocking socket takes the output in pieces
+*/
+BOOL seg_test(VOID)	{
+	XDR		xdrM, xdrE;
+	XDR_IOVEC *piov;
+#ifdef PIPE_SOCKET
+	PIPE	pipe;
+	FILE	*pf;
+	INT		k;
+#endif
+	CHAR	*pb;
+	UINT	cb, c, i, off;
+	BOOL	fOk;
+
+	xdrmem_create(&xdrM, NULL, 0, XDR_ENCODE);	// reference
+	fOk = stream_msg(&xdrM, XDR_ENCODE, STREAM_INTS) &&
+		  stream_msg(&xdrM, XDR_ENCODE, 7);
+	cb	= xdr_getpos(&xdrM);
+	pb	= (CHAR *)malloc(cb + 1);
+
+	xdrseg_create(&xdrE, 64, 128);			// segments, blob by reference
+	for(i = 0; fOk && (i < 2); i++)	{		// reset in between
+		fOk = stream_msg(&xdrE, XDR_ENCODE, STREAM_INTS) &&
+			  stream_msg(&xdrE, XDR_ENCODE, 7) &&
+			  (xdr_getpos(&xdrE) == cb) &&
+			  ((piov = xdrseg_iov(&xdrE, &c)) != NULL) && (c > 2);
+		for(off = 0; fOk && c--; off += (piov++)->iov_len)
+			fOk = (off + piov->iov_len <= cb) &&
+				  !memcmp((CHAR *)xdrmem_base(&xdrM) + off, piov->iov_base,
+															piov->iov_len);
+		fOk = fOk && (off == cb);
+		xdrseg_reset(&xdrE);
+		}
+#ifdef PIPE_SOCKET
+	if(fOk && ((pf = tmpfile()) != NULL))	{
+		fOk = stream_msg(&xdrE, XDR_ENCODE, STREAM_INTS) &&
+			  stream_msg(&xdrE, XDR_ENCODE, 7) &&
+			  xdrseg_writev(&xdrE, fileno(pf));
+		rewind(pf);
+		fOk = fOk && (fread(pb, 1, cb + 1, pf) == cb) &&
+			  !memcmp(pb, xdrmem_base(&xdrM), cb);
+		fclose(pf);
+		}
+	xdrseg_reset(&xdrE);					// non-blocking: resume after
+	xdr_setpos(&xdrM, 0);					// EAGAIN
+	for(i = 0; fOk && (i < STREAM_MSGS); i++)
+		fOk = stream_msg(&xdrM, XDR_ENCODE, STREAM_INTS) &&
+			  stream_msg(&xdrE, XDR_ENCODE, STREAM_INTS);
+	cb = xdr_getpos(&xdrM);
+	free(pb);
+	if(fOk && ((pb = (CHAR *)malloc(cb)) != NULL) && pipe_open(&pipe))	{
+		fOk = (fcntl(pipe.afd[1], F_SETFL, O_NONBLOCK) == 0);
+		for(off = 0, c = 0; fOk && (off < cb); )	{
+			if(!xdrseg_writev(&xdrE, pipe.afd[1]))	{
+				fOk = (errno == EAGAIN) || (errno == EWOULDBLOCK);
+				c++;
+				}
+			k = (cb - off < 4096)? cb - off : 4096;	// drain a part only
+			fOk = fOk && ((k = pipe_read(&pipe, pb + off, k)) > 0);
+			off += k;
+			}
+		fOk = fOk && (c > 0) && !memcmp(pb, xdrmem_base(&xdrM), cb) &&
+			  xdrseg_writev(&xdrE, pipe.afd[1]);	// nothing left
+		pipe_close(&pipe, TRUE);
+		}
+	else
+		fOk = FALSE;
+#endif
+	xdr_destroy(&xdrE);
+
+	printf("segment stream: %s\n", (fOk)? "ok" : "FAILED");
+	free(pb);
+	xdr_destroy(&xdrM);
+	return fOk;
+	}
+
+/*
+* objects of par_test: fixed (8 bytes) and variable encoded size
+*/
+#define PAR_OBJS	20000
+
+typedef struct POINT	{
+	INT		x;
+	INT		y;
+	};
+
+typedef struct VAR	{
+	UINT	c;						// 0..3 valid elements of 'a'
+	INT		a[3];
+	};
+
+BOOL xdr_point(XDR *xdr, POINT *p)	{
+
+	return xdr_int(xdr, &p->x) && xdr_int(xdr, &p->y);
+	}
+
+BOOL xdr_var(XDR *xdr, VAR *p)	{
+
+	return	xdr_u_int(xdr, &p->c) && (p->c <= 3) &&
+			xdr_vector(xdr, (CHAR *)p->a, p->c, sizeof(INT), (xdrproc_t)xdr_int);
+	}
+
+/*
+* parallel arrays: encoded the same as serial ones, decoded to the same
+* objects; a wrong 'cbWire', truncated input and counters larger than
+* the buffer must fail before anything is allocated
+*/
+BOOL par_test(VOID)	{
+	static BYTE abHuge[12] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x10, 0, 0, 0,
+							   0, 0, 0, 0 };
+	XDR_POOL *pPool;
+	XDR		xdrS, xdrP, xdrD;
+	POINT	*apt, *aptD;
+	VAR		*avar, *avarD;
+	INT		*pi;
+	UINT	c, cD, cb, i;
+	BOOL	fOk;
+
+	apt	 = (POINT *)malloc(PAR_OBJS * sizeof(POINT));
+	avar = (VAR *)calloc(PAR_OBJS, sizeof(VAR));
+	aptD = (POINT *)calloc(PAR_OBJS, sizeof(POINT));
+	avarD= (VAR *)calloc(PAR_OBJS, sizeof(VAR));
+	if(!apt || !avar || !aptD || !avarD || ((pPool = xdrpool_create(4)) == NULL))
+		return FALSE;
+
+	for(i = 0; i < PAR_OBJS; i++)	{
+		apt[i].x	= i;
+		apt[i].y	= -(INT)i;
+		avar[i].c	= i % 4;			// unused elements stay 0
+		for(c = 0; c < avar[i].c; c++)
+			avar[i].a[c] = i * (c + 1);
+		}
+	c = PAR_OBJS;
+
+	xdrmem_create(&xdrS, NULL, 0, XDR_ENCODE);	// serial
+	fOk = xdr_array(&xdrS, (CHAR **)&apt, &c, ~0U, sizeof(POINT),
+											(xdrproc_t)xdr_point) &&
+		  xdr_vector(&xdrS, (CHAR *)avar, c, sizeof(VAR), (xdrproc_t)xdr_var);
+
+	xdrmem_create(&xdrP, NULL, 0, XDR_ENCODE);	// parallel, same bytes?
+	xdr_setpool(&xdrP, pPool);
+	fOk = fOk && xdr_array_par(&xdrP, (CHAR **)&apt, &c, ~0U, sizeof(POINT),
+											8, (xdrproc_t)xdr_point) &&
+		  xdr_vector_par(&xdrP, (CHAR *)avar, c, sizeof(VAR), 0,
+											(xdrproc_t)xdr_var) &&
+		  (xdr_getpos(&xdrP) == xdr_getpos(&xdrS)) &&
+		  !memcmp(xdrmem_base(&xdrP), xdrmem_base(&xdrS), xdr_getpos(&xdrS));
+	cb = xdr_getpos(&xdrP);
+	fOk = fOk && !xdr_vector_par(&xdrP, (CHAR *)apt, c, sizeof(POINT), 12,
+											(xdrproc_t)xdr_point);
+
+	xdrmem_create(&xdrD, xdrmem_base(&xdrP), cb, XDR_DECODE);
+	xdr_setpool(&xdrD, pPool);
+	fOk = fOk && xdr_array_par(&xdrD, (CHAR **)&aptD, &cD, ~0U, sizeof(POINT),
+											8, (xdrproc_t)xdr_point) &&
+		  (cD == c) && !memcmp(aptD, apt, c * sizeof(POINT)) &&
+		  xdr_vector_par(&xdrD, (CHAR *)avarD, c, sizeof(VAR), 0,
+											(xdrproc_t)xdr_var) &&
+		  !memcmp(avarD, avar, c * sizeof(VAR)) && (xdr_getpos(&xdrD) == cb);
+	xdr_destroy(&xdrD);
+
+	xdrmem_create(&xdrD, xdrmem_base(&xdrP), cb, XDR_DECODE);
+	xdr_setpool(&xdrD, pPool);				// wrong size on the wire
+	fOk = fOk && !xdr_array_par(&xdrD, (CHAR **)&aptD, &cD, ~0U,
+							sizeof(POINT), 12, (xdrproc_t)xdr_point);
+	xdr_destroy(&xdrD);
+
+	xdrmem_create(&xdrD, xdrmem_base(&xdrP), 4 + (c - 1) * 8, XDR_DECODE);
+	xdr_setpool(&xdrD, pPool);				// last point cut off
+	fOk = fOk && !xdr_array_par(&xdrD, (CHAR **)&aptD, &cD, ~0U,
+							sizeof(POINT), 8, (xdrproc_t)xdr_point) &&
+		  xdr_setpos(&xdrD, 4) &&
+		  !xdr_vector_par(&xdrD, (CHAR *)aptD, c, sizeof(POINT), 8,
+											(xdrproc_t)xdr_point);
+	xdr_destroy(&xdrD);
+
+	xdrmem_create(&xdrD, (CHAR *)abHuge, sizeof(abHuge), XDR_DECODE);
+	xdr_setpool(&xdrD, pPool);				// counters beyond the buffer
+	pi = NULL;
+	fOk = fOk && !xdr_array_par(&xdrD, (CHAR **)&pi, &cD, ~0U, sizeof(INT),
+											0, (xdrproc_t)xdr_int) &&
+		  (pi == NULL) && xdr_setpos(&xdrD, 0) &&
+		  !xdr_array_par(&xdrD, (CHAR **)&pi, &cD, ~0U, sizeof(POINT),
+											8, (xdrproc_t)xdr_point) &&
+		  (pi == NULL) && xdr_setpos(&xdrD, 4) &&
+		  !xdr_array_par(&xdrD, (CHAR **)&pi, &cD, ~0U, sizeof(POINT),
+											8, (xdrproc_t)xdr_point) &&
+		  (pi == NULL) && xdr_setpos(&xdrD, 4) &&
+		  !xdr_array_par(&xdrD, (CHAR **)&pi, &cD, ~0U, sizeof(INT),
+											0, (xdrproc_t)xdr_int) &&
+		  (pi == NULL);
+	xdr_destroy(&xdrD);
+	printf("parallel arrays: %s\n", (fOk)? "ok" : "FAILED");
+
+	xdr_destroy(&xdrP);
+	xdr_destroy(&xdrS);
+	xdrpool_destroy(pPool);
+	free(avarD);
+	free(aptD);
+	free(avar);
+	free(apt);
+	return fOk;
+	}
+
+/*
+* types of codec_test, described for the templates and as C filters
+*/
+typedef struct CPOINT	{
+	INT		x;
+	INT		y;
+	double	w;
+	};
+
+typedef struct SHAPE	{			// xdr::discriminated
+	INT		kind;
+	INT		i;
+	double	d;
+	CHAR	ch;
+	};
+
+typedef struct CSHAPE	{			// xdr_union
+	INT		kind;
+	union	{
+		INT		i;
+		double	d;
+		CHAR	ch;
+		} u;
+	};
+
+typedef xdr::discriminated<SHAPE, XDR_FIELD(SHAPE, kind),	// table
+			xdr::arm<0, XDR_FIELD(SHAPE, i)>, xdr::arm<1, XDR_FIELD(SHAPE, d)>,
+			xdr::arm<2>, xdr::default_arm<XDR_FIELD(SHAPE, ch)> > SHAPE_T;
+
+typedef xdr::discriminated<SHAPE, XDR_FIELD(SHAPE, kind),	// comparison
+			xdr::arm<-5, XDR_FIELD(SHAPE, i)>,
+			xdr::arm<1000, XDR_FIELD(SHAPE, d)> > SHAPE_C;
+
+namespace xdr	{
+template<> struct codec<CPOINT> : record<CPOINT, XDR_FIELD(CPOINT, x),
+							XDR_FIELD(CPOINT, y), XDR_FIELD(CPOINT, w)> {};
+}
+
+static_assert(xdr::fixed_size<CPOINT>() == 16, "CPOINT: wrong wire size");
+static_assert(SHAPE_T::use_table && !SHAPE_C::use_table, "wrong dispatch");
+
+xdr_discrim shape_t[] =	{
+	{ 1,	(xdrproc_t)xdr_double	},
+	{ 2,	(xdrproc_t)xdr_void		},
+	{ 0,	(xdrproc_t)NULL			}	};
+
+xdr_discrim shape_c[] =	{
+	{ -5,	(xdrproc_t)xdr_int		},
+	{ 1000,	(xdrproc_t)xdr_double	},
+	{ 0,	(xdrproc_t)NULL			}	};
+
+BOOL xdr_cpoint(XDR *xdr, CPOINT *p)	{
+
+	return xdr_int(xdr, &p->x) && xdr_int(xdr, &p->y) &&
+		   xdr_double(xdr, &p->w);
+	}
+
+/*
+* codec_test_shape: encode 'kind' with 'C' and decode it with xdr_union
+* (and the reverse); returns the bytes written or ~0U on error
+*/
+template<class C> UINT codec_test_shape(INT kind, xdr_discrim *choices,
+													xdrproc_t defaultarm)	{
+	XDR		xdrE, xdrD;
+	SHAPE	s, sD;
+	CSHAPE	cs;
+	UINT	cb;
+	BOOL	fOk;
+
+	memset(&s, 0, sizeof(SHAPE));
+	s.kind	= kind;
+	s.i		= kind * 3;
+	s.d		= kind * 0.5;
+	s.ch	= (CHAR)('a' + kind);
+
+	xdrmem_create(&xdrE, NULL, 0, XDR_ENCODE);
+	fOk = C::encode(&xdrE, s) && ((cb = xdr_getpos(&xdrE)) == C::size(s));
+	if(fOk)	{
+		xdrmem_create(&xdrD, xdrmem_base(&xdrE), cb, XDR_DECODE);
+		memset(&cs, 0, sizeof(CSHAPE));
+		fOk = xdr_union(&xdrD, &cs.kind, (CHAR *)&cs.u, choices, defaultarm) &&
+			  (xdr_getpos(&xdrD) == cb) && (cs.kind == kind);
+		xdr_destroy(&xdrD);
+
+		xdr_setpos(&xdrE, 0);				// and back
+		fOk = fOk && xdr_union(&xdrE, &cs.kind, (CHAR *)&cs.u, choices,
+															defaultarm) &&
+			  (xdr_getpos(&xdrE) == cb);
+		xdrmem_create(&xdrD, xdrmem_base(&xdrE), cb, XDR_DECODE);
+		memset(&sD, 0, sizeof(SHAPE));
+		sD.i  = s.i;						// only the arm is decoded
+		sD.d  = s.d;
+		sD.ch = s.ch;
+		fOk = fOk && C::decode(&xdrD, sD) && !memcmp(&sD, &s, sizeof(SHAPE));
+		xdr_destroy(&xdrD);
+		}
+	xdr_destroy(&xdrE);
+	return (fOk)? cb : ~0U;
+	}
+
+/*
+* codec templates: the bytes equal those of the C filters both ways, for
+* records, arrays, vectors, strings, unions (discriminant 0, default arm,
+* no matching arm, table and comparison dispatch) and proc<T>; LONGs that
+* don't fit into 32 bits fail
+*/
+BOOL codec_test(VOID)	{
+	static BYTE abKind3[8] = { 0, 0, 0, 3, 0, 0, 0, 0 };
+	std::vector<CPOINT>	vpt, vptD;
+	std::array<INT, 5>	ai = {{ 1, -2, 3, -4, 5 }}, aiD;
+	std::vector<LONG>	vl;
+	std::string	str("codec"), strD;
+	XDR		xdrE, xdrD;
+	CPOINT	*ppt = NULL, *pptD = NULL, aptC[3];
+	SHAPE	s;
+	CHAR	*psz = NULL;
+	INT		aint[5];
+	UINT	c, cb, i;
+	LONG	l;
+	BOOL	fOk;
+
+	for(i = 0; i < 3; i++)	{
+		aptC[i].x = i;
+		aptC[i].y = -(INT)i;
+		aptC[i].w = i * 0.25;
+		vpt.push_back(aptC[i]);
+		}
+
+	xdrmem_create(&xdrE, NULL, 0, XDR_ENCODE);	// templates -> C filters
+	fOk = xdr::encode(&xdrE, vpt) && xdr::encode(&xdrE, ai) &&
+		  xdr::encode(&xdrE, str) && (xdr_getpos(&xdrE) ==
+			xdr::size(vpt) + xdr::size(ai) + xdr::size(str)) &&
+		  (xdr::size(vpt) == 4 + 3 * xdr::fixed_size<CPOINT>());
+	cb = xdr_getpos(&xdrE);
+	xdrmem_create(&xdrD, xdrmem_base(&xdrE), cb, XDR_DECODE);
+	fOk = fOk && xdr_array(&xdrD, (CHAR **)&pptD, &c, 10, sizeof(CPOINT),
+											(xdrproc_t)xdr_cpoint) &&
+		  (c == 3) && !memcmp(pptD, aptC, sizeof(aptC)) &&
+		  xdr_vector(&xdrD, (CHAR *)aint, 5, sizeof(INT), (xdrproc_t)xdr_int) &&
+		  !memcmp(aint, ai.data(), sizeof(aint)) &&
+		  xdr_string(&xdrD, &psz, 16) && !strcmp(psz, "codec") &&
+		  (xdr_getpos(&xdrD) == cb);
+	xdr_destroy(&xdrD);
+
+	xdr_setpos(&xdrE, 0);						// C filters -> templates
+	ppt = aptC;
+	c	= 3;
+	fOk = fOk && xdr_array(&xdrE, (CHAR **)&ppt, &c, 10, sizeof(CPOINT),
+											(xdrproc_t)xdr_cpoint) &&
+		  xdr_vector(&xdrE, (CHAR *)aint, 5, sizeof(INT), (xdrproc_t)xdr_int) &&
+		  xdr_string(&xdrE, &psz, 16) && (xdr_getpos(&xdrE) == cb);
+	xdrmem_create(&xdrD, xdrmem_base(&xdrE), cb, XDR_DECODE);
+	fOk = fOk && xdr::decode(&xdrD, vptD) && (vptD.size() == 3) &&
+		  !memcmp(vptD.data(), aptC, sizeof(aptC)) &&
+		  xdr::decode(&xdrD, aiD) && (aiD == ai) &&
+		  xdr::decode(&xdrD, strD) && (strD == str);
+	xdr_setpos(&xdrD, 0);						// proc<T> for C routines
+	free(pptD);
+	pptD = NULL;
+	fOk = fOk && xdr_array(&xdrD, (CHAR **)&pptD, &c, 10, sizeof(CPOINT),
+											xdr::proc<CPOINT>()) &&
+		  (c == 3) && !memcmp(pptD, aptC, sizeof(aptC));
+	xdr_destroy(&xdrD);
+	free(pptD);
+	free(psz);
+
+	for(INT k = 0; fOk && (k < 4); k++)		// table: 0, arms, default
+		fOk = (codec_test_shape<SHAPE_T>((k < 3)? k : 7, shape_t,
+							(k)? (xdrproc_t)xdr_char : (xdrproc_t)xdr_int)
+																!= ~0U);
+	fOk = fOk && (codec_test_shape<SHAPE_C>(-5, shape_c, NULL) == 8) &&
+		  (codec_test_shape<SHAPE_C>(1000, shape_c, NULL) == 12);
+
+	xdr_setpos(&xdrE, 0);						// no matching arm
+	memset(&s, 0, sizeof(SHAPE));
+	s.kind = 3;
+	fOk = fOk && !SHAPE_C::encode(&xdrE, s) && (xdr_getpos(&xdrE) == 4);
+	xdrmem_create(&xdrD, (CHAR *)abKind3, sizeof(abKind3), XDR_DECODE);
+	fOk = fOk && !SHAPE_C::decode(&xdrD, s) && xdr_setpos(&xdrD, 0) &&
+		  SHAPE_T::decode(&xdrD, s) && (s.ch == 0);
+	xdr_destroy(&xdrD);
+
+	l = 123456;									// LONG: 32 bit only
+	xdr_setpos(&xdrE, 0);
+	fOk = fOk && xdr::encode(&xdrE, l) && (xdr_getpos(&xdrE) == 4);
+	if(sizeof(LONG) > 4)	{
+		l = (LONG)((ULONG)1 << (8 * sizeof(LONG) - 2)) + 5;
+		vl.assign(3, 7);
+		vl[2] = l;
+		fOk = fOk && !xdr::encode(&xdrE, l) && !xdr::encode(&xdrE, (ULONG)l) &&
+			  !xdr::encode(&xdrE, vl) && (l != 5);
+		}
+	xdr_destroy(&xdrE);
+
+	printf("codec templates: %s\n", (fOk)? "ok" : "FAILED");
+	return fOk;
+	}
+
 /************************************************************************/
 
-main(void)	{
+int main(void)	{
 	XDR xdrE;
 
 #ifdef MEMSTREAM
@@ -64,8 +1290,8 @@ main(void)	{
 	strcpy(str, "test string");
 	xdr_string(&xdrE, &str, 256);
 
-	INT aint[4];					// encode array of integers
-	for(INT j = 0; j < 4; j++)
+	INT aint[4], j;					// encode array of integers
+	for(j = 0; j < 4; j++)
 		aint[j] = 100+j;
 	xdr_vector(&xdrE, (CHAR *)aint, 4, 4, (xdrproc_t)xdr_int);
 
@@ -130,7 +1356,18 @@ main(void)	{
 		printf("aint[%d] = %d\n", j, aint[j]);
 	printf("test_union.character = %c\n", test_union.character);
 
-	return 0;
+	BOOL fOk = feed_test();
+	fOk = rec_test() && fOk;
+	fOk = ref_test() && fOk;
+	fOk = inline_test() && fOk;
+	fOk = long_test() && fOk;
+	fOk = arena_test() && fOk;
+	fOk = bulk_test() && fOk;
+	fOk = file_test() && fOk;
+	fOk = seg_test() && fOk;
+	fOk = par_test() && fOk;
+	fOk = codec_test() && fOk;
+	return (fOk)? 0 : 1;
 	}
 
 